@@ -17,7 +17,13 @@
     #include <sys/sysinfo.h>
     #include <sys/statvfs.h>
     #include <pwd.h>
+    #include <fcntl.h>
+    #include <dirent.h>
+    #include <time.h>
     #include <X11/Xlib.h>
+    #ifdef __SSE2__
+        #include <emmintrin.h>
+    #endif
 #endif
 
 #define ANSI_COLOR_RED     "\x1b[31m"
@@ -67,6 +73,8 @@ typedef struct {
 // Forward declarations
 void get_system_info(SystemInfo *info);
 void display_system_info(SystemInfo *info);
+int run_audit(const char* profile_path, int json_output);
+int run_irq_report(int interval_ms, int json_output);
 
 // Helper function to execute a command and get output
 char* execute_command(const char* cmd) {
@@ -113,7 +121,7 @@ char* read_file_content(const char* filename) {
 #endif
 
 // Main function
-int main() {
+int main(int argc, char* argv[]) {
     #ifdef _WIN32
         // Enable ANSI escape sequences in Windows terminal
         HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -123,6 +131,45 @@ int main() {
         SetConsoleMode(hOut, dwMode);
     #endif
 
+    // --audit [profile] checks performance tuning knobs, --irq [interval_ms] samples
+    // interrupt distribution, --json switches either report to JSON
+    int audit = 0, irq = 0, json_output = 0;
+    int interval_ms = 1000;
+    const char* profile_path = NULL;
+    const char* usage = "Usage: %s [--audit [profile] | --irq [interval_ms]] [--json]\n";
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--audit") == 0) {
+            audit = 1;
+            if (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) {
+                profile_path = argv[++i];
+            }
+        } else if (strcmp(argv[i], "--irq") == 0) {
+            irq = 1;
+            if (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) {
+                interval_ms = atoi(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "--json") == 0) {
+            json_output = 1;
+        } else {
+            fprintf(stderr, usage, argv[0]);
+            return 2;
+        }
+    }
+    if (audit && irq) {
+        fprintf(stderr, usage, argv[0]);
+        return 2;
+    }
+    if (audit) {
+        return run_audit(profile_path, json_output);
+    }
+    if (irq) {
+        if (interval_ms <= 0) {
+            fprintf(stderr, "--irq interval must be a positive number of milliseconds\n");
+            return 2;
+        }
+        return run_irq_report(interval_ms, json_output);
+    }
+
     SystemInfo info;
     get_system_info(&info);
     display_system_info(&info);
@@ -358,6 +405,22 @@ void get_system_info(SystemInfo *info) {
     get_bios_info(info->bios_version, sizeof(info->bios_version));
 }
 
+// The tuning audit reads Linux sysfs/procfs knobs and has no Windows equivalent
+int run_audit(const char* profile_path, int json_output) {
+    (void)profile_path;
+    (void)json_output;
+    fprintf(stderr, "--audit is only supported on Linux\n");
+    return 2;
+}
+
+// Interrupt counters come from /proc/interrupts and /proc/softirqs
+int run_irq_report(int interval_ms, int json_output) {
+    (void)interval_ms;
+    (void)json_output;
+    fprintf(stderr, "--irq is only supported on Linux\n");
+    return 2;
+}
+
 #else
 // Linux-specific system information gathering
 
@@ -617,6 +680,947 @@ void get_system_info(SystemInfo *info) {
     get_motherboard_info(info->motherboard, sizeof(info->motherboard));
     get_bios_info(info->bios_version, sizeof(info->bios_version));
 }
+
+// Performance tuning audit
+//
+// Every knob is read with a single openat()/read() relative to an already open
+// directory, so per-core and per-device checks avoid a full path walk and stdio
+// buffering for each of the hundreds of small sysfs files on large hosts.
+
+#define AUDIT_VALUE_SIZE 128
+
+typedef enum {
+    AUDIT_GOVERNOR,
+    AUDIT_EPP,
+    AUDIT_MAX_CSTATE,
+    AUDIT_THP_ENABLED,
+    AUDIT_THP_DEFRAG,
+    AUDIT_NUMA_BALANCING,
+    AUDIT_SWAPPINESS,
+    AUDIT_NR_HUGEPAGES,
+    AUDIT_BUDDY_HIGH_ORDER,
+    AUDIT_SCHEDULER,
+    AUDIT_NR_REQUESTS,
+    AUDIT_SMT,
+    AUDIT_MITIGATIONS,
+    AUDIT_CHECK_COUNT
+} AuditCheckId;
+
+typedef enum { AUDIT_NA, AUDIT_INFO, AUDIT_PASS, AUDIT_FAIL } AuditStatus;
+typedef enum { MATCH_EXACT, MATCH_AT_LEAST, MATCH_PER_CLASS } AuditMatch;
+
+typedef struct {
+    const char* key;    // Profile key and JSON name
+    const char* label;  // Table label
+    AuditMatch match;
+    char expected[AUDIT_VALUE_SIZE];
+    char observed[AUDIT_VALUE_SIZE];
+    char example[AUDIT_VALUE_SIZE];  // First deviating instance, e.g. "cpu3=powersave"
+    int total;          // Instances inspected (cpus, devices or 1 for scalar knobs)
+    int deviant;        // Instances not matching the profile (or the first value without one)
+    AuditStatus status;
+} AuditCheck;
+
+static AuditCheck audit_checks[AUDIT_CHECK_COUNT] = {
+    [AUDIT_GOVERNOR]         = {"governor", "CPU governor", MATCH_EXACT},
+    [AUDIT_EPP]              = {"epp", "CPU EPP", MATCH_EXACT},
+    [AUDIT_MAX_CSTATE]       = {"max_cstate", "C-state limit", MATCH_EXACT},
+    [AUDIT_THP_ENABLED]      = {"thp_enabled", "THP mode", MATCH_EXACT},
+    [AUDIT_THP_DEFRAG]       = {"thp_defrag", "THP defrag", MATCH_EXACT},
+    [AUDIT_NUMA_BALANCING]   = {"numa_balancing", "NUMA balancing", MATCH_EXACT},
+    [AUDIT_SWAPPINESS]       = {"swappiness", "Swappiness", MATCH_EXACT},
+    [AUDIT_NR_HUGEPAGES]     = {"nr_hugepages", "Hugepage pools", MATCH_PER_CLASS},
+    [AUDIT_BUDDY_HIGH_ORDER] = {"buddy_high_order_pct", "Free mem in 2MB blocks %", MATCH_AT_LEAST},
+    [AUDIT_SCHEDULER]        = {"scheduler", "Block scheduler", MATCH_EXACT},
+    [AUDIT_NR_REQUESTS]      = {"nr_requests", "Block nr_requests", MATCH_PER_CLASS},
+    [AUDIT_SMT]              = {"smt", "SMT control", MATCH_EXACT},
+    [AUDIT_MITIGATIONS]      = {"mitigations", "Mitigations", MATCH_EXACT},
+};
+
+// Read a whole sysfs/procfs file relative to dirfd, stripping the trailing newline
+static int read_at(int dirfd, const char* path, char* buffer, size_t max_len) {
+    int fd = openat(dirfd, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+
+    size_t len = 0;
+    ssize_t n;
+    // seq_file backed procfs files may hand out one page per read()
+    while (len < max_len - 1 && (n = read(fd, buffer + len, max_len - 1 - len)) > 0) {
+        len += (size_t)n;
+    }
+    close(fd);
+
+    buffer[len] = '\0';
+    if (len > 0 && buffer[len - 1] == '\n') buffer[len - 1] = '\0';
+    return (int)len;
+}
+
+// Slurp a procfs file; the buffer is zero padded so vector loads may overrun the text
+static char* read_proc_file(const char* path) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+
+    size_t capacity = 1 << 16, len = 0;
+    char* buffer = malloc(capacity + 16);
+    ssize_t n;
+    while (buffer && (n = read(fd, buffer + len, capacity - len)) > 0) {
+        len += (size_t)n;
+        if (len == capacity) {
+            capacity *= 2;
+            char* grown = realloc(buffer, capacity + 16);
+            if (!grown) free(buffer);
+            buffer = grown;
+        }
+    }
+    close(fd);
+
+    if (buffer) memset(buffer + len, 0, 16);
+    return buffer;
+}
+
+// "always [madvise] never" -> "madvise"; values without brackets are returned as is
+static char* active_choice(char* value) {
+    char* start = strchr(value, '[');
+    if (!start) return value;
+    start++;
+    start[strcspn(start, "]")] = '\0';
+    return start;
+}
+
+// Find the expected value for one instance of a MATCH_PER_CLASS knob: the first
+// "class:value" entry whose class prefixes who, else a bare "value" default
+static int audit_class_expected(const char* expected, const char* who, char* out, size_t max_len) {
+    int found = 0;
+    const char* entry = expected;
+    while (*entry) {
+        size_t len = strcspn(entry, ",");
+        const char* colon = memchr(entry, ':', len);
+        const char* value = colon ? colon + 1 : entry;
+        size_t value_len = len - (size_t)(value - entry);
+        int class_match = colon && who && strncmp(who, entry, (size_t)(colon - entry)) == 0;
+        if (class_match || (!colon && !found)) {
+            if (value_len >= max_len) value_len = max_len - 1;
+            memcpy(out, value, value_len);
+            out[value_len] = '\0';
+            found = 1;
+            if (class_match) return 1;
+        }
+        entry += len;
+        if (*entry == ',') entry++;
+    }
+    return found;
+}
+
+static int audit_matches(const AuditCheck* check, const char* who, const char* value) {
+    if (check->match == MATCH_AT_LEAST) {
+        return strtod(value, NULL) >= strtod(check->expected, NULL);
+    }
+    if (check->match == MATCH_PER_CLASS) {
+        char expected[AUDIT_VALUE_SIZE];
+        // Classes the profile does not mention are not constrained
+        if (!audit_class_expected(check->expected, who, expected, sizeof(expected))) return 1;
+        return strcmp(value, expected) == 0;
+    }
+    return strcmp(value, check->expected) == 0;
+}
+
+// Record one instance of a knob; who names the cpu/device, NULL for scalar knobs
+static void audit_observe(AuditCheckId id, const char* who, const char* value) {
+    AuditCheck* check = &audit_checks[id];
+
+    if (check->total++ == 0) {
+        strncpy(check->observed, value, sizeof(check->observed) - 1);
+    }
+
+    int deviates = check->expected[0] ? !audit_matches(check, who, value)
+                                      : strcmp(value, check->observed) != 0;
+    if (deviates && check->deviant++ == 0) {
+        if (who) {
+            snprintf(check->example, sizeof(check->example), "%s=%s", who, value);
+        } else {
+            strncpy(check->example, value, sizeof(check->example) - 1);
+        }
+    }
+}
+
+static void audit_finalize(AuditCheck* check) {
+    if (check->total == 0) {
+        strcpy(check->observed, "n/a");
+        check->status = AUDIT_NA;
+        return;
+    }
+
+    if (check->expected[0]) {
+        check->status = check->deviant ? AUDIT_FAIL : AUDIT_PASS;
+    } else {
+        check->status = AUDIT_INFO;
+    }
+
+    if (check->deviant && check->total > 1) {
+        if (check->expected[0]) {
+            snprintf(check->observed, sizeof(check->observed), "%s (%d/%d deviate)",
+                     check->example, check->deviant, check->total);
+        } else {
+            char first[AUDIT_VALUE_SIZE];
+            strncpy(first, check->observed, sizeof(first) - 1);
+            first[sizeof(first) - 1] = '\0';
+            snprintf(check->observed, sizeof(check->observed), "%.40s, mixed: %.60s (%d/%d)",
+                     first, check->example, check->deviant, check->total);
+        }
+    }
+}
+
+// Load "key=value" lines into the expected column; '#' starts a comment.
+// Per-class knobs take "class:value" lists matched against the instance name, with
+// an optional bare default, e.g. nr_requests=nvme:1023,sd:256 or
+// nr_hugepages=2048kB:1024,1048576kB:16
+static int load_audit_profile(const char* profile_path) {
+    FILE* profile = fopen(profile_path, "r");
+    if (!profile) return -1;
+
+    char line[256];
+    while (fgets(line, sizeof(line), profile)) {
+        line[strcspn(line, "#\r\n")] = 0;
+        char* eq = strchr(line, '=');
+        if (!eq) continue;
+        *eq = '\0';
+
+        char* key = line;
+        char* value = eq + 1;
+        while (*key == ' ' || *key == '\t') key++;
+        while (*value == ' ' || *value == '\t') value++;
+        key[strcspn(key, " \t")] = 0;
+        value[strcspn(value, " \t")] = 0;
+
+        int found = 0;
+        for (int i = 0; i < AUDIT_CHECK_COUNT; i++) {
+            if (strcmp(key, audit_checks[i].key) == 0) {
+                strncpy(audit_checks[i].expected, value, sizeof(audit_checks[i].expected) - 1);
+                found = 1;
+                break;
+            }
+        }
+        if (!found) {
+            fprintf(stderr, "Unknown audit profile key: %s\n", key);
+        }
+    }
+    fclose(profile);
+    return 0;
+}
+
+static void audit_scalar(AuditCheckId id, int dirfd, const char* path, int bracketed) {
+    char value[AUDIT_VALUE_SIZE];
+    if (read_at(dirfd, path, value, sizeof(value)) > 0) {
+        audit_observe(id, NULL, bracketed ? active_choice(value) : value);
+    }
+}
+
+// Each affected entry in vulnerabilities/ is one instance, "Not affected" ones are
+// skipped; mitigations=, nopti, spectre_v2=off etc. all surface here as "vulnerable"
+static void audit_vulnerabilities(int cpu_dir) {
+    int vuln_dir = openat(cpu_dir, "vulnerabilities", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (vuln_dir < 0) return;
+    DIR* vulnerabilities = fdopendir(vuln_dir);
+    if (!vulnerabilities) {
+        close(vuln_dir);
+        return;
+    }
+
+    struct dirent* entry;
+    char value[AUDIT_VALUE_SIZE];
+    while ((entry = readdir(vulnerabilities)) != NULL) {
+        if (entry->d_name[0] == '.') continue;
+        if (read_at(vuln_dir, entry->d_name, value, sizeof(value)) <= 0) continue;
+
+        // Partial mitigations ("Mitigation: ...; BHI: Vulnerable", "SMT vulnerable") and
+        // KVM prefixed states ("KVM: Mitigation: Split huge pages") are matched anywhere
+        if (strstr(value, "Not affected")) continue;
+        const char* state = strstr(value, "Vulnerable") || strstr(value, "vulnerable") ? "vulnerable" :
+                            strstr(value, "Mitigation") ? "mitigated" : "unknown";
+        audit_observe(AUDIT_MITIGATIONS, entry->d_name, state);
+    }
+    closedir(vulnerabilities);
+}
+
+// intel_idle is usually built in, so its parameters exist even when acpi_idle or no
+// cpuidle driver is active; the limit is taken from whichever driver is in use
+static void audit_cstate_limit(int cpu_dir) {
+    char driver[64];
+    if (read_at(cpu_dir, "cpuidle/current_driver", driver, sizeof(driver)) <= 0) return;
+
+    if (strcmp(driver, "intel_idle") == 0) {
+        audit_scalar(AUDIT_MAX_CSTATE, AT_FDCWD, "/sys/module/intel_idle/parameters/max_cstate", 0);
+    } else if (strcmp(driver, "acpi_idle") == 0) {
+        audit_scalar(AUDIT_MAX_CSTATE, AT_FDCWD, "/sys/module/processor/parameters/max_cstate", 0);
+    }
+}
+
+// Governor and EPP of every online core with a cpufreq driver, C-states, SMT and vulnerabilities
+static void audit_cpus(void) {
+    int cpu_dir = open("/sys/devices/system/cpu", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (cpu_dir < 0) return;
+
+    long cpu_count = sysconf(_SC_NPROCESSORS_CONF);
+    char path[96], who[32], value[AUDIT_VALUE_SIZE];
+    for (long cpu = 0; cpu < cpu_count; cpu++) {
+        snprintf(who, sizeof(who), "cpu%ld", cpu);
+        snprintf(path, sizeof(path), "cpu%ld/cpufreq/scaling_governor", cpu);
+        if (read_at(cpu_dir, path, value, sizeof(value)) > 0) {
+            audit_observe(AUDIT_GOVERNOR, who, value);
+        }
+        snprintf(path, sizeof(path), "cpu%ld/cpufreq/energy_performance_preference", cpu);
+        if (read_at(cpu_dir, path, value, sizeof(value)) > 0) {
+            audit_observe(AUDIT_EPP, who, value);
+        }
+    }
+
+    audit_cstate_limit(cpu_dir);
+    audit_scalar(AUDIT_SMT, cpu_dir, "smt/control", 0);
+    audit_vulnerabilities(cpu_dir);
+    close(cpu_dir);
+}
+
+// Persistent pool of every hugepage size, one instance per size such as "2048kB"
+static void audit_hugepage_pools(void) {
+    DIR* hugepages = opendir("/sys/kernel/mm/hugepages");
+    if (!hugepages) return;
+
+    int hugepages_dir = dirfd(hugepages);
+    struct dirent* entry;
+    char path[320], value[AUDIT_VALUE_SIZE];
+    while ((entry = readdir(hugepages)) != NULL) {
+        if (strncmp(entry->d_name, "hugepages-", 10) != 0) continue;
+        snprintf(path, sizeof(path), "%s/nr_hugepages", entry->d_name);
+        if (read_at(hugepages_dir, path, value, sizeof(value)) > 0) {
+            audit_observe(AUDIT_NR_HUGEPAGES, entry->d_name + 10, value);
+        }
+    }
+    closedir(hugepages);
+}
+
+// Share of free memory sitting in blocks large enough for a 2MB hugepage, reported
+// for the most fragmented Normal/Movable zone. DMA and DMA32 cover at most the low
+// 4GB and are usually the most fragmented, but say little about hugepage or THP
+// allocations on a large host.
+static void audit_buddyinfo(void) {
+    char* content = read_proc_file("/proc/buddyinfo");
+    if (!content) return;
+
+    long page_size = sysconf(_SC_PAGESIZE);
+    int huge_order = 0;
+    while (page_size > 0 && (page_size << huge_order) < 2 * 1024 * 1024) huge_order++;
+
+    double worst = -1;
+    char worst_zone[64] = "";
+    char* save = NULL;
+    for (char* line = strtok_r(content, "\n", &save); line; line = strtok_r(NULL, "\n", &save)) {
+        int node, consumed;
+        char zone[32];
+        // Node 0, zone   Normal   1234   567 ...
+        if (sscanf(line, "Node %d, zone %31s%n", &node, zone, &consumed) != 2) continue;
+        if (strncmp(zone, "DMA", 3) == 0) continue;
+
+        unsigned long long total = 0, high = 0;
+        char* cursor = line + consumed;
+        char* end;
+        int order = 0;
+        while (1) {
+            unsigned long long count = strtoull(cursor, &end, 10);
+            if (end == cursor) break;
+            total += count << order;
+            if (order >= huge_order) high += count << order;
+            cursor = end;
+            order++;
+        }
+        if (total == 0) continue;
+
+        double pct = 100.0 * (double)high / (double)total;
+        if (worst < 0 || pct < worst) {
+            worst = pct;
+            snprintf(worst_zone, sizeof(worst_zone), "node%d %s", node, zone);
+        }
+    }
+    free(content);
+
+    if (worst >= 0) {
+        char value[AUDIT_VALUE_SIZE];
+        snprintf(value, sizeof(value), "%.1f (%s)", worst, worst_zone);
+        audit_observe(AUDIT_BUDDY_HIGH_ORDER, NULL, value);
+    }
+}
+
+// I/O scheduler and queue depth of every hardware block device; loop, dm, md, nbd
+// and other virtual devices have no device link and always report "none"
+static void audit_block_devices(void) {
+    DIR* block = opendir("/sys/block");
+    if (!block) return;
+
+    int block_dir = dirfd(block);
+    struct dirent* entry;
+    char path[320], value[AUDIT_VALUE_SIZE];
+    while ((entry = readdir(block)) != NULL) {
+        const char* name = entry->d_name;
+        if (name[0] == '.') continue;
+        snprintf(path, sizeof(path), "%s/device", name);
+        if (faccessat(block_dir, path, F_OK, 0) != 0) continue;
+
+        snprintf(path, sizeof(path), "%s/queue/scheduler", name);
+        if (read_at(block_dir, path, value, sizeof(value)) > 0) {
+            audit_observe(AUDIT_SCHEDULER, name, active_choice(value));
+        }
+        snprintf(path, sizeof(path), "%s/queue/nr_requests", name);
+        if (read_at(block_dir, path, value, sizeof(value)) > 0) {
+            audit_observe(AUDIT_NR_REQUESTS, name, value);
+        }
+    }
+    closedir(block);
+}
+
+static void audit_collect(void) {
+    audit_cpus();
+
+    int mm_dir = open("/sys/kernel/mm/transparent_hugepage", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (mm_dir >= 0) {
+        audit_scalar(AUDIT_THP_ENABLED, mm_dir, "enabled", 1);
+        audit_scalar(AUDIT_THP_DEFRAG, mm_dir, "defrag", 1);
+        close(mm_dir);
+    }
+
+    int sys_dir = open("/proc/sys", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (sys_dir >= 0) {
+        audit_scalar(AUDIT_NUMA_BALANCING, sys_dir, "kernel/numa_balancing", 0);
+        audit_scalar(AUDIT_SWAPPINESS, sys_dir, "vm/swappiness", 0);
+        close(sys_dir);
+    }
+
+    audit_hugepage_pools();
+    audit_buddyinfo();
+    audit_block_devices();
+}
+
+static const char* audit_status_name(AuditStatus status) {
+    switch (status) {
+        case AUDIT_PASS: return "pass";
+        case AUDIT_FAIL: return "fail";
+        case AUDIT_INFO: return "info";
+        default:         return "n/a";
+    }
+}
+
+static void print_json_string(const char* value) {
+    putchar('"');
+    for (; *value; value++) {
+        if (*value == '"' || *value == '\\') {
+            printf("\\%c", *value);
+        } else if ((unsigned char)*value < 0x20) {
+            printf("\\u%04x", *value);
+        } else {
+            putchar(*value);
+        }
+    }
+    putchar('"');
+}
+
+static void display_audit_json(int passed, int failed) {
+    printf("{\"checks\": [");
+    for (int i = 0; i < AUDIT_CHECK_COUNT; i++) {
+        const AuditCheck* check = &audit_checks[i];
+        printf("%s\n  {\"key\": \"%s\", \"expected\": ", i ? "," : "", check->key);
+        if (check->expected[0]) {
+            print_json_string(check->expected);
+        } else {
+            printf("null");
+        }
+        printf(", \"observed\": ");
+        print_json_string(check->observed);
+        printf(", \"instances\": %d, \"deviant\": %d, \"status\": \"%s\"}",
+               check->total, check->deviant, audit_status_name(check->status));
+    }
+    printf("\n], \"passed\": %d, \"failed\": %d}\n", passed, failed);
+}
+
+static void display_audit_table(int passed, int failed) {
+    printf(ANSI_BOLD "%-26s %-22s %-40s %s" ANSI_COLOR_RESET "\n", "Check", "Expected", "Observed", "Result");
+    for (int i = 0; i < AUDIT_CHECK_COUNT; i++) {
+        const AuditCheck* check = &audit_checks[i];
+        const char* color = check->status == AUDIT_PASS ? ANSI_COLOR_GREEN :
+                            check->status == AUDIT_FAIL ? ANSI_COLOR_RED : ANSI_COLOR_YELLOW;
+        printf("%-26s %-22s %-40s %s%s" ANSI_COLOR_RESET "\n", check->label,
+               check->expected[0] ? check->expected : "-", check->observed,
+               color, audit_status_name(check->status));
+    }
+    printf("----------------\n");
+    printf("%d passed, %d failed\n", passed, failed);
+}
+
+// Returns 0 when every profiled knob matches, 1 on deviations, 2 on usage errors
+int run_audit(const char* profile_path, int json_output) {
+    if (profile_path && load_audit_profile(profile_path) != 0) {
+        fprintf(stderr, "Cannot read audit profile: %s\n", profile_path);
+        return 2;
+    }
+
+    audit_collect();
+
+    int passed = 0, failed = 0;
+    for (int i = 0; i < AUDIT_CHECK_COUNT; i++) {
+        audit_finalize(&audit_checks[i]);
+        if (audit_checks[i].status == AUDIT_PASS) passed++;
+        if (audit_checks[i].status == AUDIT_FAIL) failed++;
+    }
+
+    if (json_output) {
+        display_audit_json(passed, failed);
+    } else {
+        display_audit_table(passed, failed);
+    }
+    return failed ? 1 : 0;
+}
+
+// IRQ and softirq distribution
+//
+// /proc/interrupts has one column per CPU, so on a 512 CPU host with thousands of
+// MSI-X vectors a snapshot is tens of megabytes of space padded counters. Each file
+// is pulled in with read(2) into one buffer and scanned in place; runs of padding are
+// skipped 16 bytes at a time with SSE2 where available.
+
+#define IRQ_NAME_SIZE 16
+#define IRQ_DEVICE_SIZE 96
+#define IRQ_TOP_COUNT 16
+#define IRQ_IMBALANCE_RATIO 2.0   // Flag a core taking more than twice the per-core mean
+#define IRQ_IMBALANCE_MIN_RATE 100.0
+
+typedef struct {
+    int cpu_count;
+    int* cpu_ids;                 // Column -> CPU number (offline CPUs have no column)
+    int* cpu_columns;             // CPU number -> column, -1 when the CPU has none
+    int cpu_id_limit;             // Highest CPU number + 1
+    int row_count;
+    int row_capacity;
+    char (*names)[IRQ_NAME_SIZE];
+    char (*devices)[IRQ_DEVICE_SIZE];
+    unsigned long long* counts;   // row_count x cpu_count, row major
+} IrqMatrix;
+
+typedef struct {
+    int row;
+    double rate;
+    int top_cpu;
+    double top_share;
+    char affinity[64];
+} IrqRate;
+
+typedef struct {
+    double max_rate;
+    double mean_rate;
+    int max_cpu;
+    int eligible_cpus;
+    int flagged;
+} IrqImbalance;
+
+static const char* skip_blanks(const char* p) {
+#ifdef __SSE2__
+    const __m128i blank = _mm_set1_epi8(' ');
+    for (;;) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)p);
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, blank));
+        if (mask != 0xFFFF) return p + __builtin_ctz(~mask);
+        p += 16;
+    }
+#else
+    while (*p == ' ') p++;
+    return p;
+#endif
+}
+
+static void free_irq_matrix(IrqMatrix* matrix) {
+    free(matrix->cpu_ids);
+    free(matrix->cpu_columns);
+    free(matrix->names);
+    free(matrix->devices);
+    free(matrix->counts);
+    memset(matrix, 0, sizeof(*matrix));
+}
+
+static int grow_irq_matrix(IrqMatrix* matrix) {
+    int capacity = matrix->row_capacity ? matrix->row_capacity * 2 : 256;
+    void* names = realloc(matrix->names, (size_t)capacity * IRQ_NAME_SIZE);
+    if (names) matrix->names = names;
+    void* devices = realloc(matrix->devices, (size_t)capacity * IRQ_DEVICE_SIZE);
+    if (devices) matrix->devices = devices;
+    void* counts = realloc(matrix->counts, (size_t)capacity * matrix->cpu_count * sizeof(unsigned long long));
+    if (counts) matrix->counts = counts;
+    if (!names || !devices || !counts) return -1;
+
+    matrix->row_capacity = capacity;
+    return 0;
+}
+
+// Parse /proc/interrupts or /proc/softirqs into a row x cpu counter matrix
+static int parse_irq_file(const char* path, IrqMatrix* matrix) {
+    memset(matrix, 0, sizeof(*matrix));
+    char* content = read_proc_file(path);
+    if (!content) return -1;
+
+    // Header: "           CPU0       CPU1 ..."
+    const char* p = content;
+    const char* header_end = strchr(p, '\n');
+    if (!header_end) header_end = p + strlen(p);
+    for (const char* q = p; (q = strstr(q, "CPU")) && q < header_end; q += 3) {
+        matrix->cpu_count++;
+    }
+    matrix->cpu_ids = malloc(sizeof(int) * (matrix->cpu_count ? matrix->cpu_count : 1));
+    if (!matrix->cpu_ids || matrix->cpu_count == 0) {
+        free(content);
+        free_irq_matrix(matrix);
+        return -1;
+    }
+    int column = 0;
+    for (const char* q = p; (q = strstr(q, "CPU")) && q < header_end; q += 3) {
+        matrix->cpu_ids[column] = atoi(q + 3);
+        if (matrix->cpu_ids[column] >= matrix->cpu_id_limit) {
+            matrix->cpu_id_limit = matrix->cpu_ids[column] + 1;
+        }
+        column++;
+    }
+    matrix->cpu_columns = malloc(sizeof(int) * matrix->cpu_id_limit);
+    if (!matrix->cpu_columns) {
+        free(content);
+        free_irq_matrix(matrix);
+        return -1;
+    }
+    for (int cpu = 0; cpu < matrix->cpu_id_limit; cpu++) matrix->cpu_columns[cpu] = -1;
+    for (column = 0; column < matrix->cpu_count; column++) {
+        matrix->cpu_columns[matrix->cpu_ids[column]] = column;
+    }
+
+    p = *header_end ? header_end + 1 : header_end;
+    while (*p) {
+        const char* line_end = strchr(p, '\n');
+        if (!line_end) line_end = p + strlen(p);
+
+        const char* name = skip_blanks(p);
+        const char* colon = memchr(name, ':', (size_t)(line_end - name));
+        if (!colon) {
+            p = *line_end ? line_end + 1 : line_end;
+            continue;
+        }
+        if (matrix->row_count == matrix->row_capacity && grow_irq_matrix(matrix) != 0) {
+            free(content);
+            free_irq_matrix(matrix);
+            return -1;
+        }
+
+        int row = matrix->row_count++;
+        size_t name_len = (size_t)(colon - name);
+        if (name_len >= IRQ_NAME_SIZE) name_len = IRQ_NAME_SIZE - 1;
+        memcpy(matrix->names[row], name, name_len);
+        matrix->names[row][name_len] = '\0';
+
+        // Rows such as ERR and MIS carry a single counter, so stop at the first non digit
+        unsigned long long* counts = matrix->counts + (size_t)row * matrix->cpu_count;
+        const char* cursor = colon + 1;
+        int cpu = 0;
+        for (; cpu < matrix->cpu_count; cpu++) {
+            cursor = skip_blanks(cursor);
+            if ((unsigned)(*cursor - '0') > 9) break;
+            unsigned long long value = 0;
+            while ((unsigned)(*cursor - '0') <= 9) {
+                value = value * 10 + (unsigned)(*cursor++ - '0');
+            }
+            counts[cpu] = value;
+        }
+        for (; cpu < matrix->cpu_count; cpu++) counts[cpu] = 0;
+
+        // Whatever follows the counters (chip, hwirq, handlers) with padding collapsed
+        char* device = matrix->devices[row];
+        size_t len = 0;
+        cursor = skip_blanks(cursor);
+        for (; cursor < line_end && len < IRQ_DEVICE_SIZE - 1; cursor++) {
+            if (*cursor == ' ' && (len == 0 || device[len - 1] == ' ')) continue;
+            device[len++] = *cursor;
+        }
+        while (len > 0 && device[len - 1] == ' ') len--;
+        device[len] = '\0';
+
+        p = *line_end ? line_end + 1 : line_end;
+    }
+
+    free(content);
+    return 0;
+}
+
+static int find_irq_row(const IrqMatrix* matrix, const char* name, int hint) {
+    if (hint < matrix->row_count && strcmp(matrix->names[hint], name) == 0) return hint;
+    for (int row = 0; row < matrix->row_count; row++) {
+        if (strcmp(matrix->names[row], name) == 0) return row;
+    }
+    return -1;
+}
+
+static int irq_cpu_column(const IrqMatrix* matrix, int cpu) {
+    return cpu >= 0 && cpu < matrix->cpu_id_limit ? matrix->cpu_columns[cpu] : -1;
+}
+
+// Per second delta of one cell, with columns matched by CPU number since hotplug
+// between the snapshots shifts every later column. A CPU that was offline in the
+// first snapshot has no baseline and reports no rate; a vector allocated in between
+// counts from zero.
+static double irq_delta_rate(const IrqMatrix* before, const IrqMatrix* after,
+                             int before_row, int after_row, int column, double seconds) {
+    unsigned long long now = after->counts[(size_t)after_row * after->cpu_count + column];
+    unsigned long long then = 0;
+    if (before_row >= 0) {
+        int before_column = irq_cpu_column(before, after->cpu_ids[column]);
+        if (before_column < 0) return 0.0;
+        then = before->counts[(size_t)before_row * before->cpu_count + before_column];
+    }
+    return now > then ? (double)(now - then) / seconds : 0.0;
+}
+
+// Mark the columns named by an smp_affinity_list such as "0-3,8,10-11"
+static void mark_affinity_list(const IrqMatrix* matrix, const char* list, char* eligible) {
+    const char* p = list;
+    while (*p) {
+        char* end;
+        long first = strtol(p, &end, 10);
+        if (end == p) break;
+        long last = first;
+        if (*end == '-') {
+            p = end + 1;
+            last = strtol(p, &end, 10);
+            if (end == p) break;
+        }
+        for (long cpu = first; cpu <= last && cpu < matrix->cpu_id_limit; cpu++) {
+            int column = irq_cpu_column(matrix, (int)cpu);
+            if (column >= 0) eligible[column] = 1;
+        }
+        p = *end == ',' ? end + 1 : end;
+        if (*end != ',') break;
+    }
+}
+
+// The mean only covers CPUs eligible to take the interrupts, so queues deliberately
+// confined to a few NUMA local cores are not reported against idle cores elsewhere
+static IrqImbalance irq_imbalance(const double* rates, const int* cpu_ids,
+                                  const char* eligible, int cpu_count) {
+    IrqImbalance result = {0.0, 0.0, cpu_count ? cpu_ids[0] : 0, 0, 0};
+    double total = 0.0;
+    for (int i = 0; i < cpu_count; i++) {
+        if (!eligible[i]) continue;
+        result.eligible_cpus++;
+        total += rates[i];
+        if (rates[i] > result.max_rate) {
+            result.max_rate = rates[i];
+            result.max_cpu = cpu_ids[i];
+        }
+    }
+    result.mean_rate = result.eligible_cpus ? total / result.eligible_cpus : 0.0;
+    result.flagged = result.max_rate >= IRQ_IMBALANCE_MIN_RATE &&
+                     result.max_rate > IRQ_IMBALANCE_RATIO * result.mean_rate;
+    return result;
+}
+
+static int compare_irq_rate(const void* a, const void* b) {
+    double ra = ((const IrqRate*)a)->rate, rb = ((const IrqRate*)b)->rate;
+    return (ra < rb) - (ra > rb);
+}
+
+static void print_irq_imbalance_json(const char* name, const IrqImbalance* imbalance) {
+    printf("\"%s\": {\"max_rate\": %.1f, \"mean_rate\": %.1f, \"max_cpu\": %d, "
+           "\"eligible_cpus\": %d, \"flagged\": %s}",
+           name, imbalance->max_rate, imbalance->mean_rate, imbalance->max_cpu,
+           imbalance->eligible_cpus, imbalance->flagged ? "true" : "false");
+}
+
+static void print_irq_imbalance(const char* name, const IrqImbalance* imbalance) {
+    double ratio = imbalance->mean_rate > 0 ? imbalance->max_rate / imbalance->mean_rate : 0.0;
+    printf(ANSI_COLOR_RED ANSI_BOLD "%s imbalance: " ANSI_COLOR_RESET
+           "cpu%d at %.0f/s vs %.1f/s mean over %d eligible CPUs (%.1fx) %s\n",
+           name, imbalance->max_cpu, imbalance->max_rate, imbalance->mean_rate,
+           imbalance->eligible_cpus, ratio,
+           imbalance->flagged ? ANSI_COLOR_RED "IMBALANCED" ANSI_COLOR_RESET
+                              : ANSI_COLOR_GREEN "ok" ANSI_COLOR_RESET);
+}
+
+// Two snapshots interval_ms apart; returns 1 when interrupts or NET_RX are imbalanced
+int run_irq_report(int interval_ms, int json_output) {
+    IrqMatrix irq_before, irq_after, soft_before, soft_after;
+    struct timespec start, end;
+
+    if (parse_irq_file("/proc/interrupts", &irq_before) != 0) {
+        fprintf(stderr, "Cannot read /proc/interrupts\n");
+        return 2;
+    }
+    int have_softirqs = parse_irq_file("/proc/softirqs", &soft_before) == 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    struct timespec pause = {interval_ms / 1000, (long)(interval_ms % 1000) * 1000000L};
+    nanosleep(&pause, NULL);
+
+    if (parse_irq_file("/proc/interrupts", &irq_after) != 0) {
+        fprintf(stderr, "Cannot read /proc/interrupts\n");
+        free_irq_matrix(&irq_before);
+        if (have_softirqs) free_irq_matrix(&soft_before);
+        return 2;
+    }
+    if (have_softirqs && parse_irq_file("/proc/softirqs", &soft_after) != 0) {
+        free_irq_matrix(&soft_before);
+        have_softirqs = 0;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+    int cpu_count = irq_after.cpu_count;
+    double* irq_rates = calloc((size_t)cpu_count, sizeof(double));
+    double* net_rx_rates = calloc((size_t)cpu_count, sizeof(double));
+    IrqRate* rows = calloc((size_t)irq_after.row_count + 1, sizeof(IrqRate));
+    char* eligible = calloc((size_t)cpu_count, 1);
+    if (!irq_rates || !net_rx_rates || !rows || !eligible) {
+        fprintf(stderr, "Out of memory\n");
+        free(eligible);
+        free(rows);
+        free(irq_rates);
+        free(net_rx_rates);
+        free_irq_matrix(&irq_before);
+        free_irq_matrix(&irq_after);
+        if (have_softirqs) {
+            free_irq_matrix(&soft_before);
+            free_irq_matrix(&soft_after);
+        }
+        return 2;
+    }
+
+    // Device interrupts are the numbered rows; LOC, RES, TLB and friends are per-cpu
+    // architecture interrupts that do not follow smp_affinity
+    int device_rows = 0;
+    for (int row = 0; row < irq_after.row_count; row++) {
+        if ((unsigned)(irq_after.names[row][0] - '0') > 9) continue;
+        int before_row = find_irq_row(&irq_before, irq_after.names[row], row);
+        IrqRate* rate = &rows[device_rows++];
+        rate->row = row;
+        double top = 0.0;
+        for (int column = 0; column < cpu_count; column++) {
+            double cell = irq_delta_rate(&irq_before, &irq_after, before_row, row, column, seconds);
+            irq_rates[column] += cell;
+            rate->rate += cell;
+            if (cell > top) {
+                top = cell;
+                rate->top_cpu = irq_after.cpu_ids[column];
+            }
+        }
+        rate->top_share = rate->rate > 0 ? top / rate->rate : 0.0;
+
+        // Affinity of every active vector feeds the set of CPUs eligible for interrupts;
+        // idle vectors are skipped so thousands of unused MSI-X entries cost nothing
+        if (rate->rate > 0) {
+            char path[64], list[4096];
+            snprintf(path, sizeof(path), "/proc/irq/%s/smp_affinity_list", irq_after.names[row]);
+            if (read_at(AT_FDCWD, path, list, sizeof(list)) > 0) {
+                snprintf(rate->affinity, sizeof(rate->affinity), "%.63s", list);
+                mark_affinity_list(&irq_after, list, eligible);
+            } else {
+                strcpy(rate->affinity, "?");
+            }
+        }
+    }
+    qsort(rows, (size_t)device_rows, sizeof(IrqRate), compare_irq_rate);
+    int top_count = device_rows < IRQ_TOP_COUNT ? device_rows : IRQ_TOP_COUNT;
+    while (top_count > 0 && rows[top_count - 1].rate <= 0) top_count--;
+
+    // /proc/softirqs has a column for every possible CPU while /proc/interrupts only
+    // has online ones, so columns are mapped by CPU number
+    if (have_softirqs) {
+        int net_rx = find_irq_row(&soft_after, "NET_RX", 0);
+        int net_rx_before = find_irq_row(&soft_before, "NET_RX", 0);
+        for (int column = 0; net_rx >= 0 && column < soft_after.cpu_count; column++) {
+            int target = irq_cpu_column(&irq_after, soft_after.cpu_ids[column]);
+            if (target >= 0) {
+                net_rx_rates[target] = irq_delta_rate(&soft_before, &soft_after, net_rx_before,
+                                                      net_rx, column, seconds);
+            }
+        }
+    }
+
+    // CPUs that actually took work were eligible too (RPS, unreadable affinity)
+    for (int column = 0; column < cpu_count; column++) {
+        if (irq_rates[column] > 0 || net_rx_rates[column] > 0) eligible[column] = 1;
+    }
+    IrqImbalance irq_balance = irq_imbalance(irq_rates, irq_after.cpu_ids, eligible, cpu_count);
+    IrqImbalance net_rx_balance = irq_imbalance(net_rx_rates, irq_after.cpu_ids, eligible, cpu_count);
+
+    if (json_output) {
+        printf("{\"interval_s\": %.3f, \"cpus\": [", seconds);
+        for (int column = 0; column < cpu_count; column++) {
+            printf("%s\n  {\"cpu\": %d, \"irq_rate\": %.1f, \"net_rx_rate\": %.1f}", column ? "," : "",
+                   irq_after.cpu_ids[column], irq_rates[column], net_rx_rates[column]);
+        }
+        printf("\n], \"irqs\": [");
+        for (int i = 0; i < top_count; i++) {
+            printf("%s\n  {\"irq\": ", i ? "," : "");
+            print_json_string(irq_after.names[rows[i].row]);
+            printf(", \"device\": ");
+            print_json_string(irq_after.devices[rows[i].row]);
+            printf(", \"affinity\": ");
+            print_json_string(rows[i].affinity);
+            printf(", \"rate\": %.1f, \"top_cpu\": %d, \"top_share\": %.3f}",
+                   rows[i].rate, rows[i].top_cpu, rows[i].top_share);
+        }
+        printf("\n], \"imbalance\": {");
+        print_irq_imbalance_json("irq", &irq_balance);
+        if (have_softirqs) {
+            printf(", ");
+            print_irq_imbalance_json("net_rx", &net_rx_balance);
+        } else {
+            printf(", \"net_rx\": null");
+        }
+        printf("}}\n");
+    } else {
+        printf("IRQ distribution over %.2f s, %d CPUs, %d device IRQs\n", seconds, cpu_count, device_rows);
+        printf("----------------\n");
+        // Idle cores are left out so a 512 CPU host stays readable
+        printf(ANSI_BOLD "%-8s %12s %12s" ANSI_COLOR_RESET "\n", "CPU", "IRQ/s", "NET_RX/s");
+        int idle = 0;
+        for (int column = 0; column < cpu_count; column++) {
+            if (irq_rates[column] <= 0 && net_rx_rates[column] <= 0) {
+                idle++;
+                continue;
+            }
+            int hot = (irq_balance.flagged && irq_rates[column] > IRQ_IMBALANCE_RATIO * irq_balance.mean_rate) ||
+                      (net_rx_balance.flagged && net_rx_rates[column] > IRQ_IMBALANCE_RATIO * net_rx_balance.mean_rate);
+            printf("cpu%-5d %12.0f %12.0f%s\n", irq_after.cpu_ids[column], irq_rates[column],
+                   net_rx_rates[column], hot ? ANSI_COLOR_RED "  hot" ANSI_COLOR_RESET : "");
+        }
+        if (idle) printf("(%d idle CPUs not shown)\n", idle);
+
+        printf("----------------\n");
+        printf(ANSI_BOLD "%-8s %12s %-16s %-16s %s" ANSI_COLOR_RESET "\n",
+               "IRQ", "Rate/s", "Top CPU", "Affinity", "Device");
+        for (int i = 0; i < top_count; i++) {
+            char top[32];
+            snprintf(top, sizeof(top), "cpu%d (%.0f%%)", rows[i].top_cpu, rows[i].top_share * 100.0);
+            printf("%-8s %12.0f %-16s %-16s %s\n", irq_after.names[rows[i].row], rows[i].rate, top,
+                   rows[i].affinity, irq_after.devices[rows[i].row]);
+        }
+
+        printf("----------------\n");
+        print_irq_imbalance("IRQ", &irq_balance);
+        if (have_softirqs) print_irq_imbalance("NET_RX", &net_rx_balance);
+    }
+
+    int imbalanced = irq_balance.flagged || net_rx_balance.flagged;
+    free(eligible);
+    free(rows);
+    free(irq_rates);
+    free(net_rx_rates);
+    free_irq_matrix(&irq_before);
+    free_irq_matrix(&irq_after);
+    if (have_softirqs) {
+        free_irq_matrix(&soft_before);
+        free_irq_matrix(&soft_after);
+    }
+    return imbalanced ? 1 : 0;
+}
 #endif
 
 // Display system information